@@ -0,0 +1,158 @@
+/*
+    VSProjTypeExtractor - Visual Studio project type GUID extractor
+    VSProjStringPool.cpp - Implementation File
+    Copyright (c) 2026, Lucian Muresan.
+
+    MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    You can contact the author at :
+    - VSProjTypeExtractor homepage and source repository : https://github.com/lucianm/VSProjTypeExtractor
+*/
+
+#include "VSProjStringPool.h"
+
+#include <Windows.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+namespace VSProjTypeExtractor {
+namespace StringPool {
+
+    namespace {
+
+        struct Pool
+        {
+            std::mutex _mutex;
+            // map nodes never move, so the c_str() of the keys and the data() of the lists stay valid until cleared
+            std::map<std::string, unsigned int, std::less<>> _ids;
+            std::vector<const char*> _strings;
+            std::map<std::string, std::vector<InternedCfgPlatform>, std::less<>> _lists;
+
+            Pool()
+            {
+                Reset();
+            }
+
+            // must be called with _mutex held
+            void Reset()
+            {
+                _ids.clear();
+                _strings.clear();
+                _lists.clear();
+                _strings.push_back(_ids.emplace(std::string(), 0u).first->first.c_str());
+            }
+        };
+
+        Pool& ThePool()
+        {
+            static Pool s_Pool;
+            return s_Pool;
+        }
+    }
+
+    unsigned int Intern(const wchar_t* str, std::size_t length)
+    {
+        if (!str || length == 0)
+        {
+            return 0;
+        }
+
+        // convert on the stack, configuration and platform names hardly ever exceed VSPROJ_MAXSTRING_LENGTH
+        char buffer[VSPROJ_MAXSTRING_LENGTH * 2];
+        std::string longStr;
+        std::string_view converted;
+        int numBytes = ::WideCharToMultiByte(CP_ACP, 0, str, int(length), buffer, int(sizeof(buffer)), nullptr, nullptr);
+        if (numBytes > 0)
+        {
+            converted = std::string_view(buffer, std::size_t(numBytes));
+        }
+        else
+        {
+            numBytes = ::WideCharToMultiByte(CP_ACP, 0, str, int(length), nullptr, 0, nullptr, nullptr);
+            longStr.resize(std::size_t(numBytes > 0 ? numBytes : 0));
+            if (numBytes > 0)
+            {
+                ::WideCharToMultiByte(CP_ACP, 0, str, int(length), longStr.data(), numBytes, nullptr, nullptr);
+            }
+            converted = longStr;
+        }
+
+        Pool& pool = ThePool();
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        auto it = pool._ids.find(converted);
+        if (it == pool._ids.end())
+        {
+            it = pool._ids.emplace(std::string(converted), static_cast<unsigned int>(pool._strings.size())).first;
+            pool._strings.push_back(it->first.c_str());
+        }
+        return it->second;
+    }
+
+    const char* Resolve(unsigned int id)
+    {
+        Pool& pool = ThePool();
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        return id < pool._strings.size() ? pool._strings[id] : nullptr;
+    }
+
+    const InternedCfgPlatform* InternCfgPlatforms(const unsigned int* ids, unsigned int numPairs)
+    {
+        if (!ids || numPairs == 0)
+        {
+            return nullptr;
+        }
+
+        // the list is keyed by the raw bytes of its IDs
+        const std::string_view key(reinterpret_cast<const char*>(ids), std::size_t(numPairs) * 2 * sizeof(unsigned int));
+
+        Pool& pool = ThePool();
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        auto it = pool._lists.find(key);
+        if (it == pool._lists.end())
+        {
+            std::vector<InternedCfgPlatform> list(numPairs);
+            for (unsigned int i = 0; i < numPairs; i++)
+            {
+                const unsigned int configId = ids[2 * i];
+                const unsigned int platformId = ids[2 * i + 1];
+                list[i]._configId = configId;
+                list[i]._platformId = platformId;
+                list[i]._config = configId < pool._strings.size() ? pool._strings[configId] : pool._strings[0];
+                list[i]._platform = platformId < pool._strings.size() ? pool._strings[platformId] : pool._strings[0];
+            }
+            it = pool._lists.emplace(std::string(key), std::move(list)).first;
+        }
+        return it->second.data();
+    }
+
+    void Clear()
+    {
+        Pool& pool = ThePool();
+        std::lock_guard<std::mutex> lock(pool._mutex);
+        pool.Reset();
+    }
+}
+}
@@ -0,0 +1,75 @@
+/*
+    VSProjTypeExtractor - Visual Studio project type GUID extractor
+    VSProjStringPool.h - Header File
+    Copyright (c) 2026, Lucian Muresan.
+
+    MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    You can contact the author at :
+    - VSProjTypeExtractor homepage and source repository : https://github.com/lucianm/VSProjTypeExtractor
+*/
+
+#pragma once
+
+#include "VSProjTypeExtractor.h"
+
+#include <cstddef>
+
+
+
+// process-wide, thread-safe interning of configuration and platform names
+//
+// VSProjStringPool.cpp is compiled without /clr, as <mutex> is not available to managed code, so this header
+// must not expose any standard synchronization types.
+namespace VSProjTypeExtractor {
+namespace StringPool {
+
+    /** @brief  Interns a string, converted to the ANSI code page just like marshal_as<const char*> does
+
+        Only the first occurrence of a string allocates.
+
+        @param[in] str UTF-16 characters, as pinned from a managed string
+        @param[in] length number of characters
+        @return the ID of the interned string, 0 is the empty string
+    */
+    unsigned int Intern(const wchar_t* str, std::size_t length);
+
+    /** @brief  Returns the interned string of an ID
+
+        @return the interned string, stable until @Clear, or nullptr for unknown IDs
+    */
+    const char* Resolve(unsigned int id);
+
+    /** @brief  Interns a whole list of configuration / platform pairs
+
+        Projects of a tree mostly share the same few lists, which are therefore stored only once.
+
+        @param[in] ids interleaved configuration and platform IDs, as returned by @Intern
+        @param[in] numPairs number of configuration / platform pairs
+        @return the interned list, stable until @Clear, or nullptr if numPairs is 0
+    */
+    const InternedCfgPlatform* InternCfgPlatforms(const unsigned int* ids, unsigned int numPairs);
+
+    /** @brief  Releases all interned strings and lists, invalidating all handles and IDs handed out so far
+    */
+    void Clear();
+}
+}
@@ -28,11 +28,15 @@
 */
 
 #include "VSProjTypeExtractor.h"
+#include "VSProjTypeRegistry.h"
+#include "VSProjStringPool.h"
 
 #include <msclr/marshal.h>
 #include <msclr/lock.h>
+#include <vcclr.h>
 #include <string.h>
 #include <fstream>
+#include <vector>
 
 
 
@@ -48,6 +52,15 @@ namespace VSProjTypeExtractor {
             m_managedWorker(gcnew VSProjTypeExtractorManaged::VSProjTypeWorker()),
             m_LockableObject(gcnew System::Object())
         {
+            // extend the project type registry by the mappings from the <project_types> configuration section
+            msclr::interop::marshal_context context;
+            for each (VSProjTypeExtractorManaged::ProjectTypeMapping^ mapping in m_managedWorker->ProjectTypes)
+            {
+                VSProjTypeExtractor::Registry::AddRuntimeEntry(
+                    VSProjTypeExtractor::Registry::ParseKeyKind(context.marshal_as<const char*>(mapping->_kind)),
+                    context.marshal_as<const char*>(mapping->_key),
+                    context.marshal_as<const char*>(mapping->_typeGuid));
+            }
         }
         ClassWorker(const ClassWorker%) { throw gcnew System::InvalidOperationException("ClassWorker cannot be copy-constructed"); }
 
@@ -72,6 +85,19 @@ namespace VSProjTypeExtractor {
             }
         }
 
+        // returns the cached managed ExtractedProjData^ (or nullptr if not cached), does not wait for extractions in progress
+        VSProjTypeExtractorManaged::ExtractedProjData^ GetCachedProjDataManaged(System::String^ projPath)
+        {
+            // No lock needed — the result cache is thread-safe
+            return m_managedWorker->TryGetCachedProjectData(projPath);
+        }
+
+        unsigned long long GetInvalidationCount()
+        {
+            // No lock needed — the result cache is thread-safe
+            return static_cast<unsigned long long>(m_managedWorker->InvalidationCount);
+        }
+
         void CleanUp()
         {
             msclr::lock lock(m_LockableObject);
@@ -136,6 +162,55 @@ namespace VSProjTypeExtractor {
             m_managedConLog->WriteLineRethrow(ex, format, args);
         }
     };
+
+    // cached results are kept valid by watching the project files, so they are returned without touching the file system,
+    // otherwise the project is extracted, returns nullptr if the path does not exist or on failure
+    static VSProjTypeExtractorManaged::ExtractedProjData^ FetchProjDataManaged(const char* projPath, System::String^ strProjPath)
+    {
+        VSProjTypeExtractorManaged::ExtractedProjData^ ProjData = ClassWorker::Instance->GetCachedProjDataManaged(strProjPath);
+        if (ProjData == nullptr)
+        {
+            std::ifstream test_if_exists(projPath);
+            if (!test_if_exists)
+            {
+                ConsoleLogger::Instance->WriteLineError("Invalid argument, path '{0}' does not exist!!!", strProjPath);
+                return nullptr;
+            }
+            test_if_exists.close();
+
+            ProjData = ClassWorker::Instance->GetProjDataManaged(strProjPath);
+        }
+        return ProjData;
+    }
+
+    // the configured <project_types> are added to the registry by the ClassWorker constructor, which the CLR runs exactly
+    // once and lets concurrent callers wait for, so no registry lookup can race with Registry::AddRuntimeEntry
+    static void EnsureConfiguredProjectTypes()
+    {
+        static_cast<void>(ClassWorker::Instance);
+    }
+
+    static void CopyTypeGuid(const char* projPath, System::String^ typeGuid, char* dest)
+    {
+        msclr::interop::marshal_context context;
+        strncpy_s(dest, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH, context.marshal_as<const char*>(typeGuid), _TRUNCATE);
+        if (strcmp(dest, "UNKNOWN") == 0)
+        {
+            EnsureConfiguredProjectTypes();
+            // Visual Studio could not tell, the registry may still know the project type
+            Registry::ClassifyProjectFile(projPath, dest, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH);
+        }
+    }
+
+    static unsigned int InternManaged(System::String^ str)
+    {
+        if (str == nullptr || str->Length == 0)
+        {
+            return 0;
+        }
+        pin_ptr<const wchar_t> pinnedStr = PtrToStringChars(str);
+        return StringPool::Intern(pinnedStr, str->Length);
+    }
 }
 
 
@@ -152,36 +227,26 @@ bool Vspte_GetProjData(const char* projPath, ExtractedProjData* projData)
         VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, projPath is a null pointer!!!");
         return false;
     }
-    else
-    {
-        std::ifstream test_if_exists(projPath);
-        if (!test_if_exists)
-        {
-            VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, path '{0}' does not exist!!!", gcnew System::String(projPath));
-            return false;
-        }
-    }
-    
+
     // clean out data
     memset(projData, 0, sizeof(ExtractedProjData));
     System::String^ strProjPath = gcnew System::String(projPath);
 
     try
     {
-        VSProjTypeExtractorManaged::ExtractedProjData^ ProjData = VSProjTypeExtractor::ClassWorker::Instance->GetProjDataManaged(strProjPath);
+        VSProjTypeExtractorManaged::ExtractedProjData^ ProjData = VSProjTypeExtractor::FetchProjDataManaged(projPath, strProjPath);
         bSuccess = ProjData != nullptr;
 
         if (bSuccess && ProjData->_TypeGuid != nullptr && ProjData->_TypeGuid->Length > 0)
         {
-            // Single marshal_context for all conversions
-            msclr::interop::marshal_context context;
-
-            const char* typeGuidCStr = context.marshal_as<const char*>(ProjData->_TypeGuid);
-            strncpy_s(projData->_TypeGuid, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH, typeGuidCStr, _TRUNCATE);
+            VSProjTypeExtractor::CopyTypeGuid(projPath, ProjData->_TypeGuid, projData->_TypeGuid);
 
             // Config/Platform entries
             if (ProjData->_ConfigsPlatforms && ProjData->_ConfigsPlatforms->Length > 0)
             {
+                // Single marshal_context for all conversions
+                msclr::interop::marshal_context context;
+
                 projData->_numCfgPlatforms = ProjData->_ConfigsPlatforms->Length;
                 projData->_pConfigsPlatforms = new ExtractedCfgPlatform[projData->_numCfgPlatforms];
 
@@ -207,6 +272,89 @@ bool Vspte_GetProjData(const char* projPath, ExtractedProjData* projData)
     }
 }
 
+bool Vspte_GetProjDataInterned(const char* projPath, InternedProjData* projData)
+{
+    bool bSuccess = false;
+    if (!projData)
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, projData is a null pointer!!!");
+        return false;
+    }
+    if (!projPath)
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, projPath is a null pointer!!!");
+        return false;
+    }
+
+    // clean out data
+    memset(projData, 0, sizeof(InternedProjData));
+    System::String^ strProjPath = gcnew System::String(projPath);
+
+    try
+    {
+        VSProjTypeExtractorManaged::ExtractedProjData^ ProjData = VSProjTypeExtractor::FetchProjDataManaged(projPath, strProjPath);
+        bSuccess = ProjData != nullptr;
+
+        if (bSuccess && ProjData->_TypeGuid != nullptr && ProjData->_TypeGuid->Length > 0)
+        {
+            VSProjTypeExtractor::CopyTypeGuid(projPath, ProjData->_TypeGuid, projData->_TypeGuid);
+
+            // Config/Platform entries, interned straight from the pinned managed strings, without marshalling copies
+            if (ProjData->_ConfigsPlatforms && ProjData->_ConfigsPlatforms->Length > 0)
+            {
+                const unsigned int numCfgPlatforms = ProjData->_ConfigsPlatforms->Length;
+                std::vector<unsigned int> ids(2 * numCfgPlatforms);
+
+                for (unsigned int i = 0; i < numCfgPlatforms; i++)
+                {
+                    ids[2 * i] = VSProjTypeExtractor::InternManaged(ProjData->_ConfigsPlatforms[i]->_config);
+                    ids[2 * i + 1] = VSProjTypeExtractor::InternManaged(ProjData->_ConfigsPlatforms[i]->_platform);
+                }
+
+                projData->_pConfigsPlatforms = VSProjTypeExtractor::StringPool::InternCfgPlatforms(ids.data(), numCfgPlatforms);
+                projData->_numCfgPlatforms = numCfgPlatforms;
+            }
+        }
+
+        return bSuccess;
+    }
+    catch (System::Exception^ e)
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineException(e, "occurred for project file '{0}'", strProjPath);
+        return false;
+    }
+}
+
+const char* Vspte_GetInternedString(unsigned int id)
+{
+    return VSProjTypeExtractor::StringPool::Resolve(id);
+}
+
+bool Vspte_GetProjTypeGuid(const char* projPath, char* typeGuid)
+{
+    if (!typeGuid)
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, typeGuid is a null pointer!!!");
+        return false;
+    }
+    if (!projPath)
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineError("Invalid argument, projPath is a null pointer!!!");
+        return false;
+    }
+
+    // clean out data
+    memset(typeGuid, 0, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH);
+
+    VSProjTypeExtractor::EnsureConfiguredProjectTypes();
+    if (!VSProjTypeExtractor::Registry::ClassifyProjectFile(projPath, typeGuid, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH))
+    {
+        VSProjTypeExtractor::ConsoleLogger::Instance->WriteLineDebug("Project type of '{0}' is not known to the registry", gcnew System::String(projPath));
+        return false;
+    }
+    return true;
+}
+
 void Vspte_DeallocateProjDataCfgArray(ExtractedProjData* projData)
 {
     if (!projData)
@@ -219,7 +367,13 @@ void Vspte_DeallocateProjDataCfgArray(ExtractedProjData* projData)
     projData->_numCfgPlatforms = 0;
 }
 
+unsigned long long Vspte_GetInvalidationCount()
+{
+    return VSProjTypeExtractor::ClassWorker::Instance->GetInvalidationCount();
+}
+
 void Vspte_CleanUp()
 {
     VSProjTypeExtractor::ClassWorker::Instance->CleanUp();
+    VSProjTypeExtractor::StringPool::Clear();
 }
@@ -84,6 +84,27 @@ extern "C" {
         unsigned int _numCfgPlatforms;
     } ExtractedProjData;
 
+    /** interned configuration / platform pair, the strings are shared by all results and valid until @Vspte_CleanUp,
+        equal IDs or pointers mean equal strings
+    */
+    typedef struct
+    {
+        const char* _config;
+        const char* _platform;
+        unsigned int _configId;
+        unsigned int _platformId;
+    } InternedCfgPlatform;
+
+    /** extracted project data containing type GUID and the interned array of found configuration / platform pairs,
+        the array is shared by all projects having the same configurations / platforms and valid until @Vspte_CleanUp
+    */
+    typedef struct
+    {
+        char _TypeGuid[VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH];
+        const InternedCfgPlatform* _pConfigsPlatforms;
+        unsigned int _numCfgPlatforms;
+    } InternedProjData;
+
     /** @brief  Retrieves basic project data from an existing project
 
         The project data is extracted by silently automating the loading of the project in a volatile solution of a new,
@@ -94,6 +115,35 @@ extern "C" {
     */
     CDECL_VSPROJTYPEEXTRACTOR bool __stdcall Vspte_GetProjData(const char* projPath, ExtractedProjData* projData);
 
+    /** @brief  Retrieves basic project data from an existing project, with interned configurations / platforms
+
+        Same as @Vspte_GetProjData, but the configuration / platform pairs are not copied into a newly allocated array,
+        they are interned in a process-wide table instead, so memory does not grow with the number of projects sharing
+        the same configurations / platforms. Nothing needs to be deallocated, all handles stay valid until @Vspte_CleanUp.
+
+        @param[in] projPath path to visual studio project file
+        @param[in,out] projData for receiving the project type GUID and existing configurations
+    */
+    CDECL_VSPROJTYPEEXTRACTOR bool __stdcall Vspte_GetProjDataInterned(const char* projPath, InternedProjData* projData);
+
+    /** @brief  Resolves the ID of an interned configuration or platform name as found in InternedCfgPlatform
+
+        @return the interned string valid until @Vspte_CleanUp, or nullptr if the ID is unknown
+    */
+    CDECL_VSPROJTYPEEXTRACTOR const char* __stdcall Vspte_GetInternedString(unsigned int id);
+
+    /** @brief  Retrieves the project type GUID of an existing project without involving Visual Studio
+
+        The project type is resolved by a lookup in a compile-time registry of well-known project types, keyed by the referenced SDK,
+        well-known imported targets (e.g. Wix.targets, Microsoft.CSharp.targets) or the extension of the project file. The registry
+        can be extended by the <project_types> section of VsProjTypeExtractorManaged.xml.
+
+        @param[in] projPath path to visual studio project file
+        @param[out] typeGuid buffer of at least VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH characters for receiving the project type GUID
+        @return false if the project type is not known to the registry, @Vspte_GetProjData can still be used in this case
+    */
+    CDECL_VSPROJTYPEEXTRACTOR bool __stdcall Vspte_GetProjTypeGuid(const char* projPath, char* typeGuid);
+
     /** @brief  Deallocates the configurations / platforms array of an ExtractedProjData instance already used in a call to @Vspte_GetProjData
 
         After a call to @Vspte_GetProjData and copying the data you're interested in from the ExtractedProjData object, you should call this
@@ -101,11 +151,19 @@ extern "C" {
     */
     CDECL_VSPROJTYPEEXTRACTOR void __stdcall Vspte_DeallocateProjDataCfgArray(ExtractedProjData* projData);
 
+    /** @brief  Number of cached results dropped so far because a file they depend on was changed, created or deleted
+
+        Only meaningful if the result cache is enabled in the <result_cache> section of VsProjTypeExtractorManaged.xml, in which case
+        @Vspte_GetProjData returns cached results without touching the file system, as long as no change was noticed. Always 0 otherwise.
+    */
+    CDECL_VSPROJTYPEEXTRACTOR unsigned long long __stdcall Vspte_GetInvalidationCount();
+
     /** @brief  Optionally closes the volatile solution and quits the Visual Studio instance
 
         After a call to @Vspte_GetProjData, the Visual Studio instance is kept up and running with the volatile solution loaded,
         in order to save time in subsequent calls to @Vspte_GetProjData. Cleanup is done anyway on application exit, so calling it
-        explicitely is not necessary, it's provided more for testing purposes
+        explicitely is not necessary, it's provided more for testing purposes. The result cache, if enabled, is emptied as well,
+        and all interned strings handed out by @Vspte_GetProjDataInterned become invalid.
     */
     CDECL_VSPROJTYPEEXTRACTOR void __stdcall Vspte_CleanUp();
 }
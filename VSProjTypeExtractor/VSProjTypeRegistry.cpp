@@ -0,0 +1,308 @@
+/*
+    VSProjTypeExtractor - Visual Studio project type GUID extractor
+    VSProjTypeRegistry.cpp - Implementation File
+    Copyright (c) 2026, Lucian Muresan.
+
+    MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    You can contact the author at :
+    - VSProjTypeExtractor homepage and source repository : https://github.com/lucianm/VSProjTypeExtractor
+*/
+
+#include "VSProjTypeRegistry.h"
+
+#include <string.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+
+namespace VSProjTypeExtractor {
+namespace Registry {
+
+    namespace {
+
+        struct RuntimeEntry
+        {
+            KeyKind _kind;
+            std::string _key;
+            std::string _typeGuid;
+        };
+
+        // usually empty or just a handful of entries, a linear scan is cheaper than any hashing here
+        std::vector<RuntimeEntry> s_RuntimeEntries;
+
+        std::string_view ExtensionOf(std::string_view path)
+        {
+            const std::size_t posSep = path.find_last_of("\\/");
+            const std::size_t posDot = path.find_last_of('.');
+            if (posDot == std::string_view::npos || (posSep != std::string_view::npos && posDot < posSep))
+            {
+                return std::string_view();
+            }
+            return path.substr(posDot);
+        }
+
+        /** returns the tag starting at pos, up to but without its closing '>'
+        */
+        std::string_view TagAt(std::string_view content, std::size_t pos)
+        {
+            const std::size_t posEnd = content.find('>', pos);
+            return content.substr(pos, posEnd == std::string_view::npos ? std::string_view::npos : posEnd - pos);
+        }
+
+        /** finds the next tag with the given name, not matching longer names like <ProjectReference
+        */
+        std::size_t FindTag(std::string_view content, std::string_view tagStart, std::size_t pos)
+        {
+            for (pos = content.find(tagStart, pos); pos != std::string_view::npos; pos = content.find(tagStart, pos + 1))
+            {
+                const std::size_t posAfter = pos + tagStart.size();
+                if (posAfter < content.size() && std::string_view(" \t\r\n/>").find(content[posAfter]) != std::string_view::npos)
+                {
+                    return pos;
+                }
+            }
+            return std::string_view::npos;
+        }
+
+        /** returns the value of an attribute of a tag, or an empty string_view if the tag has no such attribute
+        */
+        std::string_view AttributeOf(std::string_view tag, std::string_view name)
+        {
+            for (std::size_t pos = tag.find(name); pos != std::string_view::npos; pos = tag.find(name, pos + 1))
+            {
+                const std::size_t posQuote = pos + name.size() + 1;
+                if (pos == 0 || std::string_view(" \t\r\n").find(tag[pos - 1]) == std::string_view::npos ||
+                    posQuote >= tag.size() || tag[posQuote - 1] != '=' || (tag[posQuote] != '"' && tag[posQuote] != '\''))
+                {
+                    continue;
+                }
+                const std::string_view value = tag.substr(posQuote + 1);
+                return value.substr(0, value.find(tag[posQuote]));
+            }
+            return std::string_view();
+        }
+
+        /** returns the first SDK of an SDK reference, without version
+        */
+        std::string_view FirstSdkOf(std::string_view sdkReference)
+        {
+            const std::size_t posBegin = sdkReference.find_first_not_of(" \t\r\n");
+            if (posBegin == std::string_view::npos)
+            {
+                return std::string_view();
+            }
+            const std::string_view sdk = sdkReference.substr(posBegin);
+            return sdk.substr(0, sdk.find_first_of("/; \t\r\n"));
+        }
+
+        /** returns the first SDK the project references, in any of the forms MSBuild supports:
+            <Project Sdk="...">, <Sdk Name="..." /> or <Import Project="Sdk.props" Sdk="..." />
+        */
+        std::string_view SdkOf(std::string_view content)
+        {
+            const std::size_t posProject = FindTag(content, "<Project", 0);
+            if (posProject != std::string_view::npos)
+            {
+                const std::string_view sdk = FirstSdkOf(AttributeOf(TagAt(content, posProject), "Sdk"));
+                if (!sdk.empty())
+                {
+                    return sdk;
+                }
+            }
+            for (std::size_t pos = FindTag(content, "<Sdk", 0); pos != std::string_view::npos; pos = FindTag(content, "<Sdk", pos + 1))
+            {
+                const std::string_view sdk = FirstSdkOf(AttributeOf(TagAt(content, pos), "Name"));
+                if (!sdk.empty())
+                {
+                    return sdk;
+                }
+            }
+            for (std::size_t pos = FindTag(content, "<Import", 0); pos != std::string_view::npos; pos = FindTag(content, "<Import", pos + 1))
+            {
+                const std::string_view sdk = FirstSdkOf(AttributeOf(TagAt(content, pos), "Sdk"));
+                if (!sdk.empty())
+                {
+                    return sdk;
+                }
+            }
+            return std::string_view();
+        }
+
+        /** returns the file name of a path naming a "*.targets" file, or an empty string_view
+        */
+        std::string_view TargetsFileNameOf(std::string_view path)
+        {
+            static constexpr std::string_view targetsExt = ".targets";
+            const std::size_t posBegin = path.find_first_not_of(" \t\r\n");
+            if (posBegin == std::string_view::npos)
+            {
+                return std::string_view();
+            }
+            path = path.substr(posBegin, path.find_last_not_of(" \t\r\n") + 1 - posBegin);
+            if (path.size() < targetsExt.size() || !EqualsNoCase(path.substr(path.size() - targetsExt.size()), targetsExt))
+            {
+                return std::string_view();
+            }
+            const std::size_t posSep = path.find_last_of("\\/)");
+            return posSep == std::string_view::npos ? path : path.substr(posSep + 1);
+        }
+
+        /** looks up the "*.targets" files the project imports, in order of appearance: the Project attribute of <Import>
+            elements and property values like <WixTargetsPath>, which are usually imported through the property;
+            comments and item Include attributes are ignored
+        */
+        std::string_view ImportsOf(std::string_view content)
+        {
+            for (std::size_t pos = content.find('<'); pos != std::string_view::npos; )
+            {
+                if (content.compare(pos, 4, "<!--") == 0)
+                {
+                    const std::size_t posCommentEnd = content.find("-->", pos + 4);
+                    pos = posCommentEnd == std::string_view::npos ? posCommentEnd : content.find('<', posCommentEnd + 3);
+                    continue;
+                }
+
+                const std::string_view tag = TagAt(content, pos);
+                if (FindTag(tag, "<Import", 0) == 0)
+                {
+                    const std::string_view typeGuid = Lookup(KeyKind::Import, TargetsFileNameOf(AttributeOf(tag, "Project")));
+                    if (!typeGuid.empty())
+                    {
+                        return typeGuid;
+                    }
+                }
+
+                const std::size_t posText = pos + tag.size() + 1;
+                if (posText >= content.size())
+                {
+                    break;
+                }
+                pos = content.find('<', posText);
+                const std::string_view text = content.substr(posText, pos == std::string_view::npos ? std::string_view::npos : pos - posText);
+                const std::string_view typeGuid = Lookup(KeyKind::Import, TargetsFileNameOf(text));
+                if (!typeGuid.empty())
+                {
+                    return typeGuid;
+                }
+            }
+            return std::string_view();
+        }
+    }
+
+    KeyKind ParseKeyKind(std::string_view name)
+    {
+        if (EqualsNoCase(name, "extension"))
+        {
+            return KeyKind::Extension;
+        }
+        if (EqualsNoCase(name, "sdk"))
+        {
+            return KeyKind::Sdk;
+        }
+        if (EqualsNoCase(name, "sdk_project"))
+        {
+            return KeyKind::SdkProject;
+        }
+        if (EqualsNoCase(name, "import"))
+        {
+            return KeyKind::Import;
+        }
+        return KeyKind::None;
+    }
+
+    void AddRuntimeEntry(KeyKind kind, std::string_view key, std::string_view typeGuid)
+    {
+        if (kind == KeyKind::None || key.empty() || typeGuid.empty())
+        {
+            return;
+        }
+        for (RuntimeEntry& entry : s_RuntimeEntries)
+        {
+            if (entry._kind == kind && EqualsNoCase(entry._key, key))
+            {
+                entry._typeGuid = typeGuid;
+                return;
+            }
+        }
+        s_RuntimeEntries.push_back(RuntimeEntry{ kind, std::string(key), std::string(typeGuid) });
+    }
+
+    std::string_view Lookup(KeyKind kind, std::string_view key)
+    {
+        for (const RuntimeEntry& entry : s_RuntimeEntries)
+        {
+            if (entry._kind == kind && EqualsNoCase(entry._key, key))
+            {
+                return entry._typeGuid;
+            }
+        }
+        return LookupBuiltIn(kind, key);
+    }
+
+    bool ClassifyProjectFile(const char* projPath, char* typeGuid, std::size_t typeGuidSize)
+    {
+        if (!projPath || !typeGuid || typeGuidSize == 0)
+        {
+            return false;
+        }
+
+        std::ifstream projFile(projPath, std::ios::binary);
+        if (!projFile)
+        {
+            return false;
+        }
+        const std::string content((std::istreambuf_iterator<char>(projFile)), std::istreambuf_iterator<char>());
+        const std::string_view extension = ExtensionOf(projPath);
+
+        // most specific first: the SDK itself, then SDK-style projects by extension, then imports and finally the bare extension
+        std::string_view resolved;
+        const std::string_view sdk = SdkOf(content);
+        if (!sdk.empty())
+        {
+            resolved = Lookup(KeyKind::Sdk, sdk);
+            if (resolved.empty())
+            {
+                resolved = Lookup(KeyKind::SdkProject, extension);
+            }
+        }
+        if (resolved.empty())
+        {
+            resolved = ImportsOf(content);
+        }
+        if (resolved.empty())
+        {
+            resolved = Lookup(KeyKind::Extension, extension);
+        }
+        if (resolved.empty() || resolved.size() >= typeGuidSize)
+        {
+            return false;
+        }
+
+        memcpy(typeGuid, resolved.data(), resolved.size());
+        typeGuid[resolved.size()] = '\0';
+        return true;
+    }
+}
+}
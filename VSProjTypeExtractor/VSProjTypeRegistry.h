@@ -0,0 +1,223 @@
+/*
+    VSProjTypeExtractor - Visual Studio project type GUID extractor
+    VSProjTypeRegistry.h - Header File
+    Copyright (c) 2026, Lucian Muresan.
+
+    MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    You can contact the author at :
+    - VSProjTypeExtractor homepage and source repository : https://github.com/lucianm/VSProjTypeExtractor
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+
+
+namespace VSProjTypeExtractor {
+namespace Registry {
+
+    /** kind of key a project type GUID can be resolved from
+    */
+    enum class KeyKind : unsigned char
+    {
+        None,           // sentinel, never matches
+        Extension,      // project file extension, e.g. ".csproj"
+        Sdk,            // name of the first SDK referenced by <Project Sdk="...">, <Sdk Name="..." /> or <Import Sdk="..." />, e.g. "WixToolset.Sdk"
+        SdkProject,     // project file extension of a project which references any SDK in one of these forms
+        Import          // file name of a well-known imported targets file, e.g. "Wix.targets"
+    };
+
+    /** one registry entry, key comparison is case insensitive
+    */
+    struct Entry
+    {
+        KeyKind _kind;
+        std::string_view _key;
+        std::string_view _typeGuid;
+    };
+
+    /** built-in entries
+
+        The Extension and Import GUIDs are spelled like Visual Studio reports them in Project.Kind, which the tests verify for
+        C#, Python and WiX. The Sdk and SdkProject GUIDs are those of the SDK-style project systems as written into solution
+        files by Visual Studio, Project.Kind has not been verified against them and may report the legacy GUID of the language.
+        The last entry is the sentinel which empty perfect hash slots point to.
+    */
+    inline constexpr Entry s_Entries[] =
+    {
+        { KeyKind::Extension,  ".csproj",                                      "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}" },
+        { KeyKind::Extension,  ".vbproj",                                      "{F184B08F-C81C-45F6-A57F-5ABD9991F28F}" },
+        { KeyKind::Extension,  ".fsproj",                                      "{F2A71F9B-5D33-465A-A702-920D77279786}" },
+        { KeyKind::Extension,  ".vcxproj",                                     "{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}" },
+        { KeyKind::Extension,  ".pyproj",                                      "{888888a0-9f3d-457c-b088-3a5042f75d52}" },
+        { KeyKind::Extension,  ".wixproj",                                     "{930c7802-8a8c-48f9-8165-68863bccd9dd}" },
+        { KeyKind::Extension,  ".sqlproj",                                     "{00D1A9C2-B5F0-4AF3-8072-F6C62B433612}" },
+        { KeyKind::Extension,  ".njsproj",                                     "{9092AA53-FB77-4645-B42D-1CCCA6BD08BD}" },
+        { KeyKind::Extension,  ".shproj",                                      "{D954291E-2A0B-460D-934E-DC6B0785DB48}" },
+        { KeyKind::Sdk,        "WixToolset.Sdk",                               "{B7DD6F7E-DEF8-4E67-B5B7-07EF123DB6F0}" },
+        { KeyKind::SdkProject, ".csproj",                                      "{9A19103F-16F7-4668-BE54-9A1E7A4F7556}" },
+        { KeyKind::SdkProject, ".vbproj",                                      "{778DAE3C-4631-46EA-AA77-85C1314464D9}" },
+        { KeyKind::SdkProject, ".fsproj",                                      "{6EC3EE1D-3C4E-46DD-8F32-0CC8E7565705}" },
+        { KeyKind::Import,     "Microsoft.CSharp.targets",                     "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}" },
+        { KeyKind::Import,     "Microsoft.VisualBasic.targets",                "{F184B08F-C81C-45F6-A57F-5ABD9991F28F}" },
+        { KeyKind::Import,     "Microsoft.FSharp.targets",                     "{F2A71F9B-5D33-465A-A702-920D77279786}" },
+        { KeyKind::Import,     "Microsoft.Cpp.targets",                        "{8BC9CEB8-8B4A-11D0-8D11-00A0C91BC942}" },
+        { KeyKind::Import,     "Microsoft.PythonTools.targets",                "{888888a0-9f3d-457c-b088-3a5042f75d52}" },
+        { KeyKind::Import,     "Wix.targets",                                  "{930c7802-8a8c-48f9-8165-68863bccd9dd}" },
+        { KeyKind::Import,     "Microsoft.Data.Tools.Schema.SqlTasks.targets", "{00D1A9C2-B5F0-4AF3-8072-F6C62B433612}" },
+        { KeyKind::Import,     "Microsoft.NodejsTools.targets",                "{9092AA53-FB77-4645-B42D-1CCCA6BD08BD}" },
+        { KeyKind::None,       "",                                             "" }
+    };
+
+    inline constexpr std::size_t s_NumEntries = std::size(s_Entries) - 1;
+    inline constexpr std::size_t s_NumSlots = std::bit_ceil(2 * s_NumEntries);
+
+    static_assert(s_NumEntries < 256, "perfect hash slots are stored as unsigned char");
+
+    constexpr char ToLowerAscii(char c)
+    {
+        return char(c | ((unsigned char)(c - 'A') < 26u ? 0x20 : 0x00));
+    }
+
+    constexpr bool EqualsNoCase(std::string_view a, std::string_view b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            if (ToLowerAscii(a[i]) != ToLowerAscii(b[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** seeded, case insensitive FNV-1a over the key kind and the key
+    */
+    constexpr std::uint32_t Hash(KeyKind kind, std::string_view key, std::uint32_t seed)
+    {
+        std::uint32_t h = 2166136261u ^ seed;
+        h = (h ^ std::uint32_t(kind)) * 16777619u;
+        for (char c : key)
+        {
+            h = (h ^ std::uint32_t((unsigned char)ToLowerAscii(c))) * 16777619u;
+        }
+        return h;
+    }
+
+    struct PerfectHash
+    {
+        std::uint32_t _seed;
+        unsigned char _slots[s_NumSlots];
+    };
+
+    /** searches at compile time for a seed which maps every built-in entry to its own slot
+    */
+    consteval PerfectHash BuildPerfectHash()
+    {
+        for (std::uint32_t seed = 0; seed < 4096; seed++)
+        {
+            PerfectHash ph{ seed, {} };
+            for (auto& slot : ph._slots)
+            {
+                slot = (unsigned char)s_NumEntries;
+            }
+
+            bool bCollision = false;
+            for (std::size_t i = 0; i < s_NumEntries && !bCollision; i++)
+            {
+                auto& slot = ph._slots[Hash(s_Entries[i]._kind, s_Entries[i]._key, seed) & (s_NumSlots - 1)];
+                bCollision = slot != s_NumEntries;
+                slot = (unsigned char)i;
+            }
+            if (!bCollision)
+            {
+                return ph;
+            }
+        }
+        throw "no collision-free seed found for the project type registry, please enlarge s_NumSlots";
+    }
+
+    inline constexpr PerfectHash s_PerfectHash = BuildPerfectHash();
+
+    /** @brief  Looks up a project type GUID in the built-in registry
+
+        One hash, one slot probe and one key comparison, no allocation.
+
+        @param[in] kind kind of the key
+        @param[in] key key to look up, compared case insensitive
+        @return the type GUID, or an empty string_view if the key is not registered
+    */
+    constexpr std::string_view LookupBuiltIn(KeyKind kind, std::string_view key)
+    {
+        const Entry& entry = s_Entries[s_PerfectHash._slots[Hash(kind, key, s_PerfectHash._seed) & (s_NumSlots - 1)]];
+        return (entry._kind == kind && EqualsNoCase(entry._key, key)) ? entry._typeGuid : std::string_view();
+    }
+
+    // the GUIDs expected by the tests in VSProjTypeExtractorTest/test_VSProjTypeExtractor.cpp
+    static_assert(LookupBuiltIn(KeyKind::Import, "Microsoft.CSharp.targets") == "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}");
+    static_assert(LookupBuiltIn(KeyKind::Import, "Microsoft.PythonTools.targets") == "{888888a0-9f3d-457c-b088-3a5042f75d52}");
+    static_assert(LookupBuiltIn(KeyKind::Import, "wix.targets") == "{930c7802-8a8c-48f9-8165-68863bccd9dd}");
+    static_assert(LookupBuiltIn(KeyKind::Extension, ".WIXPROJ") == "{930c7802-8a8c-48f9-8165-68863bccd9dd}");
+    static_assert(LookupBuiltIn(KeyKind::Import, ".csproj").empty());
+    static_assert(LookupBuiltIn(KeyKind::Import, "Microsoft.Common.targets").empty());
+
+    /** @brief  Parses a key kind name as used in the <project_types> section of VsProjTypeExtractorManaged.xml
+
+        @return the parsed kind, or KeyKind::None if the name is unknown
+    */
+    KeyKind ParseKeyKind(std::string_view name);
+
+    /** @brief  Adds or overrides a registry entry at runtime
+
+        Runtime entries take precedence over the built-in ones. Must only be called during initialization, before any
+        lookup takes place, as the runtime entries are read without locking; VSProjTypeExtractor.cpp guarantees this by
+        adding the configured entries in the ClassWorker constructor and touching ClassWorker::Instance before lookups.
+    */
+    void AddRuntimeEntry(KeyKind kind, std::string_view key, std::string_view typeGuid);
+
+    /** @brief  Looks up a project type GUID in the runtime entries first and then in the built-in registry
+
+        @return the type GUID, or an empty string_view if the key is not registered
+    */
+    std::string_view Lookup(KeyKind kind, std::string_view key);
+
+    /** @brief  Classifies a project file by the SDK it references, its well-known imports or its extension
+
+        The project file is scanned as text, Visual Studio is not involved.
+
+        @param[in] projPath path to visual studio project file
+        @param[out] typeGuid buffer receiving the project type GUID
+        @param[in] typeGuidSize size of the typeGuid buffer
+        @return true if the project type could be resolved from the registry
+    */
+    bool ClassifyProjectFile(const char* projPath, char* typeGuid, std::size_t typeGuidSize);
+}
+}
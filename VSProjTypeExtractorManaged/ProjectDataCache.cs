@@ -0,0 +1,428 @@
+/*
+    VSProjTypeExtractor - Visual Studio project type GUID extractor
+    ProjectDataCache.cs - cache of extracted project data, invalidated by file change notifications
+    Copyright (c) 2026, Lucian Muresan.
+
+    MIT License
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    You can contact the author at :
+    - VSProjTypeExtractor homepage and source repository : https://github.com/lucianm/VSProjTypeExtractor
+*/
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text.RegularExpressions;
+using System.Threading;
+using System.Xml;
+
+namespace VSProjTypeExtractorManaged
+{
+    /// <summary>
+    /// Keeps extracted project data of long-running hosts and drops an entry only when its project file or one of
+    /// the files it imports (see CollectDependencies) is changed, created or deleted. Changes are picked up by directory change notifications, directories which cannot
+    /// be watched (or all of them, if configured so) are polled instead. Lookups never touch the file system.
+    /// </summary>
+    public sealed class ProjectDataCache : IDisposable
+    {
+        public enum WatchMode
+        {
+            AUTO,   // change notifications, polling only for directories which cannot be watched
+            NOTIFY, // change notifications only
+            POLL    // polling only
+        }
+
+        internal struct FileStamp
+        {
+            public DateTime _lastWriteUtc;
+            public long _length;
+
+            public bool IsSameAs(FileStamp other)
+            {
+                return _lastWriteUtc == other._lastWriteUtc && _length == other._length;
+            }
+        }
+
+        /// <summary>
+        /// The files a project depends on and their state before the project was loaded, see TakeSnapshot.
+        /// </summary>
+        public sealed class Snapshot
+        {
+            internal string _projKey;
+            internal Dictionary<string, FileStamp> _stamps;
+        }
+
+        private static readonly string[] _implicitImports = { "Directory.Build.props", "Directory.Build.targets" };
+        private static readonly Regex _dirProperties = new Regex(@"\$\((MSBuildThisFileDirectory|MSBuildProjectDirectory)\)", RegexOptions.IgnoreCase | RegexOptions.Compiled);
+
+        private readonly object _lock = new object();
+        private readonly WatchMode _watchMode;
+        private readonly Timer _pollTimer;
+        private readonly Dictionary<string, ExtractedProjData> _entries = new Dictionary<string, ExtractedProjData>(StringComparer.OrdinalIgnoreCase);
+        // project path -> files it depends on, and the other way round
+        private readonly Dictionary<string, HashSet<string>> _dependencies = new Dictionary<string, HashSet<string>>(StringComparer.OrdinalIgnoreCase);
+        private readonly Dictionary<string, HashSet<string>> _dependents = new Dictionary<string, HashSet<string>>(StringComparer.OrdinalIgnoreCase);
+        private readonly Dictionary<string, FileSystemWatcher> _watchers = new Dictionary<string, FileSystemWatcher>(StringComparer.OrdinalIgnoreCase);
+        private readonly Dictionary<string, FileStamp> _polledFiles = new Dictionary<string, FileStamp>(StringComparer.OrdinalIgnoreCase);
+        private long _invalidationCount = 0;
+        private bool _bDisposed = false;
+        private ConAndLog conlog = ConAndLog.Instance;
+
+        public ProjectDataCache(WatchMode watchMode, double pollIntervalSeconds)
+        {
+            _watchMode = watchMode;
+            int pollIntervalMs = Math.Max(100, Convert.ToInt32(pollIntervalSeconds * 1000));
+            _pollTimer = new Timer(_ => PollFiles(), null, pollIntervalMs, pollIntervalMs);
+        }
+
+        /// <summary>
+        /// Number of cache entries dropped because a file they depend on has changed.
+        /// </summary>
+        public long InvalidationCount => Interlocked.Read(ref _invalidationCount);
+
+        public bool TryGet(string projPath, out ExtractedProjData projData)
+        {
+            lock (_lock)
+            {
+                return _entries.TryGetValue(NormalizePath(projPath), out projData);
+            }
+        }
+
+        /// <summary>
+        /// Records the project file and the files it depends on with their modification time and size, must be taken
+        /// before the project is loaded, so that changes made while loading it are not missed by Add.
+        /// </summary>
+        public Snapshot TakeSnapshot(string projPath)
+        {
+            string projKey = NormalizePath(projPath);
+            return new Snapshot { _projKey = projKey, _stamps = CollectDependencies(projKey) };
+        }
+
+        /// <summary>
+        /// Starts tracking the files of the snapshot and caches the project data, unless one of them has changed since
+        /// the snapshot was taken.
+        /// </summary>
+        public void Add(Snapshot snapshot, ExtractedProjData projData)
+        {
+            string projKey = snapshot._projKey;
+            string changedFile = null;
+
+            lock (_lock)
+            {
+                if (_bDisposed) return;
+
+                RemoveEntry(projKey);
+                _dependencies[projKey] = new HashSet<string>(snapshot._stamps.Keys, StringComparer.OrdinalIgnoreCase);
+                foreach (var stamp in snapshot._stamps)
+                {
+                    if (!_dependents.TryGetValue(stamp.Key, out var projects))
+                    {
+                        projects = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+                        _dependents[stamp.Key] = projects;
+                        Track(stamp.Key, stamp.Value);
+                    }
+                    projects.Add(projKey);
+                }
+
+                // compared only now that all files are tracked, so that no change falls between the comparison and the tracking
+                foreach (var stamp in snapshot._stamps)
+                {
+                    if (!StampOf(stamp.Key).IsSameAs(stamp.Value))
+                    {
+                        changedFile = stamp.Key;
+                        break;
+                    }
+                }
+                if (changedFile == null)
+                {
+                    _entries[projKey] = projData;
+                }
+                else
+                {
+                    RemoveEntry(projKey);
+                }
+            }
+
+            if (changedFile == null)
+            {
+                conlog.WriteLineDebug("Cached project '{0}', tracking {1} file(s)", projKey, snapshot._stamps.Count);
+            }
+            else
+            {
+                conlog.WriteLineDebug("'{0}' changed while project '{1}' was loaded, not caching it", changedFile, projKey);
+            }
+        }
+
+        public void Clear()
+        {
+            lock (_lock)
+            {
+                foreach (var watcher in _watchers.Values)
+                {
+                    watcher?.Dispose();
+                }
+                _watchers.Clear();
+                _polledFiles.Clear();
+                _entries.Clear();
+                _dependencies.Clear();
+                _dependents.Clear();
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (_bDisposed) return;
+                _bDisposed = true;
+            }
+            _pollTimer.Dispose();
+            Clear();
+        }
+
+        private static string NormalizePath(string path)
+        {
+            return Path.GetFullPath(path);
+        }
+
+        /// <summary>
+        /// The project file itself, the Directory.Build.props / Directory.Build.targets MSBuild imports implicitly from its
+        /// folder or any folder above, and the files imported by any of these, each with its current stamp. Files which do
+        /// not exist (yet) are included as well, as creating them changes the project. Import paths are followed if they
+        /// are literal or only depend on $(MSBuildThisFileDirectory) / $(MSBuildProjectDirectory), imports depending on
+        /// other properties, e.g. the ones of MSBuild itself or of SDKs, are not tracked. Every file is stamped before
+        /// it is parsed.
+        /// </summary>
+        private Dictionary<string, FileStamp> CollectDependencies(string projPath)
+        {
+            var files = new Dictionary<string, FileStamp>(StringComparer.OrdinalIgnoreCase);
+            var pending = new Queue<string>();
+            string projDir = Path.GetDirectoryName(projPath);
+
+            void AddFile(string file)
+            {
+                if (!files.ContainsKey(file))
+                {
+                    files[file] = StampOf(file);
+                    pending.Enqueue(file);
+                }
+            }
+
+            AddFile(projPath);
+            for (string dir = projDir; !string.IsNullOrEmpty(dir); dir = Path.GetDirectoryName(dir))
+            {
+                foreach (string name in _implicitImports)
+                {
+                    AddFile(Path.Combine(dir, name));
+                }
+            }
+            while (pending.Count > 0)
+            {
+                foreach (string import in ImportsOf(pending.Dequeue(), projDir))
+                {
+                    AddFile(import);
+                }
+            }
+
+            return files;
+        }
+
+        /// <summary>
+        /// The full paths of the files imported by an MSBuild file, as far as they can be resolved without evaluating it.
+        /// </summary>
+        private List<string> ImportsOf(string file, string projDir)
+        {
+            var imports = new List<string>();
+            if (!File.Exists(file)) return imports;
+
+            try
+            {
+                string fileDir = Path.GetDirectoryName(file);
+                var doc = new XmlDocument();
+                doc.Load(file);
+                foreach (XmlNode import in doc.GetElementsByTagName("Import"))
+                {
+                    string importPath = import.Attributes?["Project"]?.Value;
+                    // SDK imports are located by the SDK resolvers of MSBuild
+                    if (string.IsNullOrEmpty(importPath) || import.Attributes["Sdk"] != null)
+                    {
+                        continue;
+                    }
+                    string resolvedPath = _dirProperties.Replace(importPath, match =>
+                        string.Equals(match.Groups[1].Value, "MSBuildProjectDirectory", StringComparison.OrdinalIgnoreCase)
+                            ? projDir
+                            : fileDir + Path.DirectorySeparatorChar);
+                    if (resolvedPath.Contains("$(") || resolvedPath.IndexOfAny(new[] { '*', '?' }) >= 0)
+                    {
+                        conlog.WriteLineDebug("Import '{0}' of '{1}' depends on properties or wildcards, its changes are not tracked", importPath, file);
+                        continue;
+                    }
+                    imports.Add(Path.GetFullPath(Path.Combine(fileDir, resolvedPath)));
+                }
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineDebug("Imports of '{0}' could not be resolved, their changes are not tracked: {1}", file, ex.Message);
+            }
+            return imports;
+        }
+
+        // must be called with _lock held, a polled file is compared against the given stamp
+        private void Track(string file, FileStamp stamp)
+        {
+            string dir = Path.GetDirectoryName(file);
+            if (_watchMode != WatchMode.POLL && !_watchers.ContainsKey(dir))
+            {
+                FileSystemWatcher watcher = null;
+                try
+                {
+                    watcher = new FileSystemWatcher(dir)
+                    {
+                        NotifyFilter = NotifyFilters.FileName | NotifyFilters.LastWrite | NotifyFilters.Size,
+                        IncludeSubdirectories = false
+                    };
+                    watcher.Changed += (s, e) => Invalidate(e.FullPath);
+                    watcher.Created += (s, e) => Invalidate(e.FullPath);
+                    watcher.Deleted += (s, e) => Invalidate(e.FullPath);
+                    watcher.Renamed += (s, e) => { Invalidate(e.OldFullPath); Invalidate(e.FullPath); };
+                    watcher.Error += (s, e) => InvalidateDirectory(dir, (FileSystemWatcher)s, e.GetException());
+                    watcher.EnableRaisingEvents = true;
+                }
+                catch (Exception ex)
+                {
+                    watcher?.Dispose();
+                    watcher = null;
+                    if (_watchMode == WatchMode.NOTIFY)
+                    {
+                        conlog.WriteLineWarn("Cannot watch folder '{0}', changes of its projects will not be noticed: {1}", dir, ex.Message);
+                    }
+                    else
+                    {
+                        conlog.WriteLineDebug("Cannot watch folder '{0}', polling its files instead: {1}", dir, ex.Message);
+                    }
+                }
+                // a null watcher remembers that the folder is polled
+                _watchers[dir] = watcher;
+            }
+
+            if (_watchMode == WatchMode.POLL || (_watchMode == WatchMode.AUTO && _watchers[dir] == null))
+            {
+                _polledFiles[file] = stamp;
+            }
+        }
+
+        private static FileStamp StampOf(string file)
+        {
+            var info = new FileInfo(file);
+            return info.Exists
+                ? new FileStamp { _lastWriteUtc = info.LastWriteTimeUtc, _length = info.Length }
+                : new FileStamp { _lastWriteUtc = DateTime.MinValue, _length = -1 };
+        }
+
+        private void PollFiles()
+        {
+            List<string> changed = new List<string>();
+            lock (_lock)
+            {
+                if (_polledFiles.Count == 0) return;
+
+                foreach (var polled in new List<KeyValuePair<string, FileStamp>>(_polledFiles))
+                {
+                    FileStamp stamp = StampOf(polled.Key);
+                    if (!stamp.IsSameAs(polled.Value))
+                    {
+                        _polledFiles[polled.Key] = stamp;
+                        changed.Add(polled.Key);
+                    }
+                }
+            }
+            foreach (string file in changed)
+            {
+                Invalidate(file);
+            }
+        }
+
+        private void Invalidate(string file)
+        {
+            int dropped = 0;
+            lock (_lock)
+            {
+                if (!_dependents.TryGetValue(file, out var projects)) return;
+
+                foreach (string projKey in new List<string>(projects))
+                {
+                    if (RemoveEntry(projKey)) dropped++;
+                }
+            }
+            if (dropped > 0)
+            {
+                Interlocked.Add(ref _invalidationCount, dropped);
+                conlog.WriteLineDebug("'{0}' changed, dropped {1} cached project(s)", file, dropped);
+            }
+        }
+
+        private void InvalidateDirectory(string dir, FileSystemWatcher watcher, Exception ex)
+        {
+            conlog.WriteLineDebug("Change notifications for folder '{0}' were lost ({1}), dropping its cached projects", dir, ex?.Message);
+            List<string> files = new List<string>();
+            lock (_lock)
+            {
+                // the watcher may not report anything anymore, e.g. once the folder was deleted and created again,
+                // so the next Track of a file in this folder sets up a new one (or polls the folder)
+                if (_watchers.TryGetValue(dir, out var current) && current == watcher)
+                {
+                    _watchers.Remove(dir);
+                }
+                foreach (string file in _dependents.Keys)
+                {
+                    if (string.Equals(Path.GetDirectoryName(file), dir, StringComparison.OrdinalIgnoreCase))
+                    {
+                        files.Add(file);
+                    }
+                }
+            }
+            watcher.Dispose();
+            foreach (string file in files)
+            {
+                Invalidate(file);
+            }
+        }
+
+        // must be called with _lock held, stops tracking files no other cached project depends on
+        private bool RemoveEntry(string projKey)
+        {
+            bool bRemoved = _entries.Remove(projKey);
+            if (_dependencies.TryGetValue(projKey, out var files))
+            {
+                _dependencies.Remove(projKey);
+                foreach (string file in files)
+                {
+                    if (_dependents.TryGetValue(file, out var projects) && projects.Remove(projKey) && projects.Count == 0)
+                    {
+                        _dependents.Remove(file);
+                        _polledFiles.Remove(file);
+                    }
+                }
+            }
+            return bRemoved;
+        }
+    }
+}
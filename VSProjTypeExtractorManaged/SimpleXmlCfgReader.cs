@@ -28,6 +28,7 @@
 */
 
 using System;
+using System.Collections.Generic;
 using System.Xml;
 using System.IO;
 
@@ -83,5 +84,27 @@ namespace VSProjTypeExtractorManaged
             }
             return strValue;
         }
+
+        public string[][] GetAttributeValuesAtNodes(string strNodePath, params string[] attributeNames)
+        {
+            var values = new List<string[]>();
+            try
+            {
+                foreach (XmlNode node in _xmlDoc.SelectNodes(strNodePath))
+                {
+                    string[] nodeValues = new string[attributeNames.Length];
+                    for (int i = 0; i < attributeNames.Length; i++)
+                    {
+                        nodeValues[i] = node.Attributes?[attributeNames[i]]?.Value ?? "";
+                    }
+                    values.Add(nodeValues);
+                }
+            }
+            catch (Exception e)
+            {
+                conlog.WriteLineRethrow(e, "The nodes at xpath '{0}' could not be read...", strNodePath);
+            }
+            return values.ToArray();
+        }
     }
 }
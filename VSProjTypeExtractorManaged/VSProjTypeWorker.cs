@@ -29,6 +29,7 @@
 
 using EnvDTE;
 using System;
+using System.Collections.Generic;
 using System.Globalization;
 using System.IO;
 using System.Reflection;
@@ -65,6 +66,26 @@ namespace VSProjTypeExtractorManaged
         }
     }
 
+    public class ProjectTypeMapping
+    {
+        public string _kind;
+        public string _key;
+        public string _typeGuid;
+
+        public ProjectTypeMapping(string kind, string key, string typeGuid)
+        {
+            _kind = kind;
+            _key = key;
+            _typeGuid = typeGuid;
+        }
+    }
+
+    public enum RecycleMode
+    {
+        SOLUTION,   // close the volatile solution and create a new one in the same Visual Studio instance
+        BACKEND     // quit the Visual Studio instance, a new one is started on the next extraction
+    }
+
     internal sealed class RetryableProjectLoadException : Exception
     {
         public RetryableProjectLoadException(string message) : base(message) { }
@@ -86,6 +107,29 @@ namespace VSProjTypeExtractorManaged
         private bool _showVisualStudio = false;
         private ConAndLog.OutMode _outModeLogging = ConAndLog.OutMode.OutNone;
         private string _strLogPath;
+        private ProjectTypeMapping[] _projectTypes = new ProjectTypeMapping[0];
+        // must match the names accepted by Registry::ParseKeyKind in VSProjTypeRegistry.cpp
+        private static readonly string[] _projectTypeKinds = { "extension", "sdk", "sdk_project", "import" };
+        private ProjectDataCache _cache = null;
+        private int _unloadBatchSize = 1;
+        private int _recycleAfterProjects = 0;
+        private long _recycleAboveDevenvMemoryMB = 0;
+        private RecycleMode _recycleMode = RecycleMode.SOLUTION;
+        private List<string> _pendingUnload = new List<string>();
+        private int _projectsSinceRecycle = 0;
+        private int _solutionGeneration = 0;
+        private System.Diagnostics.Process _devenvProcess = null;
+
+        /// <summary>
+        /// Additional project type mappings from the &lt;project_types&gt; section of the configuration file,
+        /// used by the native registry for resolving type GUIDs without Visual Studio.
+        /// </summary>
+        public ProjectTypeMapping[] ProjectTypes => _projectTypes;
+
+        /// <summary>
+        /// Number of cached results dropped because their project file or one of its imports changed, always 0 if the result cache is disabled.
+        /// </summary>
+        public long InvalidationCount => _cache?.InvalidationCount ?? 0;
 
         public VSProjTypeWorker()
         {
@@ -126,6 +170,46 @@ namespace VSProjTypeExtractorManaged
                 double approxTotalSec = double.Parse(cfgFile.GetTextValueAtNode("config/visual_studio/workaround_busy_app/retry_project/estimated_total_seconds", "10"), CultureInfo.InvariantCulture);
                 int minAttempts = Convert.ToInt32(cfgFile.GetTextValueAtNode("config/visual_studio/workaround_busy_app/retry_project/min_attempts", "2"));
                 _projRetriesCount = ComputeMaxAttempts(_projInitialRetryAfterSeconds, approxTotalSec, minAttempts);
+
+                _unloadBatchSize = Convert.ToInt32(cfgFile.GetTextValueAtNode("config/visual_studio/volatile_solution/unload_batch_size", _unloadBatchSize.ToString()));
+                _recycleAfterProjects = Convert.ToInt32(cfgFile.GetTextValueAtNode("config/visual_studio/volatile_solution/recycle_after_projects", _recycleAfterProjects.ToString()));
+                _recycleAboveDevenvMemoryMB = Convert.ToInt64(cfgFile.GetTextValueAtNode("config/visual_studio/volatile_solution/recycle_above_devenv_memory_mb", _recycleAboveDevenvMemoryMB.ToString()));
+                _recycleMode = (RecycleMode)Enum.Parse(typeof(RecycleMode), cfgFile.GetTextValueAtNode("config/visual_studio/volatile_solution/recycle_mode", Convert.ToString(_recycleMode)), true);
+
+                var projectTypes = new List<ProjectTypeMapping>();
+                foreach (string[] values in cfgFile.GetAttributeValuesAtNodes("config/project_types/project_type", "kind", "key", "guid"))
+                {
+                    var mapping = new ProjectTypeMapping(values[0], values[1], values[2]);
+                    if (Array.FindIndex(_projectTypeKinds, kind => string.Equals(kind, mapping._kind, StringComparison.OrdinalIgnoreCase)) < 0)
+                    {
+                        conlog.WriteLineWarn("Configured project type with unknown kind '{0}' (key '{1}') is ignored, kind can be: {2}", mapping._kind, mapping._key, string.Join(", ", _projectTypeKinds));
+                    }
+                    else if (string.IsNullOrWhiteSpace(mapping._key) || string.IsNullOrWhiteSpace(mapping._typeGuid))
+                    {
+                        conlog.WriteLineWarn("Configured project type {0} '{1}' -> '{2}' is ignored, both key and guid are required", mapping._kind, mapping._key, mapping._typeGuid);
+                    }
+                    else
+                    {
+                        conlog.WriteLineDebug("Configured project type {0} '{1}' -> {2}", mapping._kind, mapping._key, mapping._typeGuid);
+                        projectTypes.Add(mapping);
+                    }
+                }
+                _projectTypes = projectTypes.ToArray();
+
+                bool bResultCache = Convert.ToBoolean(cfgFile.GetTextValueAtNode("config/result_cache/enabled", "false"));
+                bool bResultCacheEnv = false;
+                if (bool.TryParse(Environment.GetEnvironmentVariable("PROJTYPEXTRACT_RESULTCACHE"), out bResultCacheEnv))
+                {
+                    bResultCache = bResultCacheEnv;
+                    conlog.WriteLineInfo("Result cache from PROJTYPEXTRACT_RESULTCACHE   : " + bResultCache);
+                }
+                if (bResultCache)
+                {
+                    var watchMode = (ProjectDataCache.WatchMode)Enum.Parse(typeof(ProjectDataCache.WatchMode), cfgFile.GetTextValueAtNode("config/result_cache/watch_mode", Convert.ToString(ProjectDataCache.WatchMode.AUTO)), true);
+                    double pollIntervalSec = double.Parse(cfgFile.GetTextValueAtNode("config/result_cache/poll_interval_seconds", "2"), CultureInfo.InvariantCulture);
+                    _cache = new ProjectDataCache(watchMode, pollIntervalSec);
+                    conlog.WriteLineInfo("Result cache enabled, watch mode {0}, poll interval {1}s", watchMode, pollIntervalSec);
+                }
             }
             catch (Exception e)
             {
@@ -140,20 +224,209 @@ namespace VSProjTypeExtractorManaged
 
         public void CleanUp()
         {
+            _cache?.Clear();
             if (!_bDteInstanciated) return;
 
+            try
+            {
+                QuitDte();
+                conlog.CloseLogging();
+            }
+            catch { }
+        }
+
+        private string VolatileSolutionName => _solutionGeneration == 0
+            ? $"{_timeStampPrefix}_{_assemblyName}.sln"
+            : $"{_timeStampPrefix}_{_assemblyName}_{_solutionGeneration}.sln";
+
+        private void StartDte()
+        {
+            string progId = $"VisualStudio.DTE.{_VS_MajorVersion}.0";
+            _dte = Activator.CreateInstance(Type.GetTypeFromProgID(progId)) as DTE;
+
+            MessageFilter.Register();
+            _dte.MainWindow.Visible = _showVisualStudio;
+            _dte.SuppressUI = !_showVisualStudio;
+            _dte.UserControl = _showVisualStudio;
+
+            try
+            {
+                GetWindowThreadProcessId(new IntPtr(_dte.MainWindow.HWnd), out uint devenvPid);
+                _devenvProcess = System.Diagnostics.Process.GetProcessById((int)devenvPid);
+            }
+            catch (Exception ex)
+            {
+                _devenvProcess = null;
+                conlog.WriteLineDebug("Visual Studio process could not be determined, its memory will not be monitored: {0}", ex.Message);
+            }
+
+            CreateVolatileSolution();
+            _bDteInstanciated = true;
+        }
+
+        /// <summary>
+        /// Closes the volatile solution and quits Visual Studio, killing it if it refuses to quit. The DTE state is
+        /// reset in any case, so that the next extraction starts a new instance.
+        /// </summary>
+        private void QuitDte()
+        {
             try
             {
                 _dte.Solution.Close(_saveVolatileSln);
-                conlog.WriteLineDebug($"Closed {_timeStampPrefix}_{_assemblyName}.sln");
+                conlog.WriteLineDebug($"Closed {VolatileSolutionName}");
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineWarn("Closing {0} failed, quitting Visual Studio anyway: {1}", VolatileSolutionName, ex.Message);
+            }
+
+            try
+            {
                 _dte.Quit();
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineWarn("Quitting Visual Studio failed, killing it: {0}", ex.Message);
+                try
+                {
+                    _devenvProcess?.Kill();
+                }
+                catch (Exception exKill)
+                {
+                    conlog.WriteLineWarn("Killing Visual Studio failed: {0}", exKill.Message);
+                }
+            }
+            finally
+            {
                 _bDteInstanciated = false;
                 MessageFilter.Revoke();
-                conlog.CloseLogging();
+
+                _devenvProcess?.Dispose();
+                _devenvProcess = null;
+                _pendingUnload.Clear();
+                _projectsSinceRecycle = 0;
+                _solutionGeneration++;
             }
-            catch { }
         }
 
+        private void CreateVolatileSolution()
+        {
+            _dte.Solution.Create(Path.GetTempPath(), VolatileSolutionName);
+            System.Threading.Thread.Sleep(Convert.ToInt32(1000 * _solutionSleepAfterCreate));
+        }
+
+        /// <summary>
+        /// Remembers an extracted project for removal from the volatile solution, and removes all remembered ones
+        /// once the configured batch size is reached. Must be called on the STA thread which loaded the project.
+        /// </summary>
+        private void ScheduleUnload(Project proj, string path)
+        {
+            if (_unloadBatchSize <= 0) return;
+
+            try
+            {
+                _pendingUnload.Add(proj.UniqueName);
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineDebug($"Project '{path}' UniqueName access threw, it stays in the solution: {ex.Message}");
+            }
+
+            if (_pendingUnload.Count < _unloadBatchSize) return;
+
+            int removed = 0;
+            try
+            {
+                var toRemove = new List<Project>();
+                foreach (Project loaded in _dte.Solution.Projects)
+                {
+                    try
+                    {
+                        if (_pendingUnload.Contains(loaded.UniqueName))
+                        {
+                            toRemove.Add(loaded);
+                        }
+                    }
+                    catch (Exception ex) { conlog.WriteLineDebug($"Project UniqueName access threw while unloading (non-fatal): {ex.Message}"); }
+                }
+                foreach (Project loaded in toRemove)
+                {
+                    _dte.Solution.Remove(loaded);
+                    removed++;
+                }
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineDebug($"Removing extracted projects from the volatile solution failed (non-fatal): {ex.Message}");
+            }
+            conlog.WriteLineDebug("Removed {0} of {1} extracted project(s) from the volatile solution", removed, _pendingUnload.Count);
+            _pendingUnload.Clear();
+        }
+
+        /// <summary>
+        /// Removes a project which could not be extracted from the volatile solution right away, regardless of the
+        /// unload batch size. Must be called on the STA thread which loaded the project.
+        /// </summary>
+        private void RemoveFailedProject(Project proj, string path)
+        {
+            try
+            {
+                _dte.Solution.Remove(proj);
+                conlog.WriteLineDebug($"Removed project '{path}' from the volatile solution after a failed attempt");
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineDebug($"Removing project '{path}' from the volatile solution after a failed attempt failed (non-fatal): {ex.Message}");
+            }
+        }
+
+        /// <summary>
+        /// Recycles the volatile solution or the whole backend once the configured project count is reached,
+        /// and always the whole backend once Visual Studio exceeds the configured memory high-water mark.
+        /// </summary>
+        private void RecycleIfNeeded()
+        {
+            long devenvMemoryMB = 0;
+            if (_recycleAboveDevenvMemoryMB > 0 && _devenvProcess != null)
+            {
+                try
+                {
+                    _devenvProcess.Refresh();
+                    devenvMemoryMB = _devenvProcess.PrivateMemorySize64 / (1024 * 1024);
+                }
+                catch (Exception ex)
+                {
+                    conlog.WriteLineDebug("Visual Studio process memory could not be read: {0}", ex.Message);
+                }
+            }
+
+            if (_recycleAboveDevenvMemoryMB > 0 && devenvMemoryMB >= _recycleAboveDevenvMemoryMB)
+            {
+                conlog.WriteLineInfo("Visual Studio uses {0} MB after {1} project(s), restarting it", devenvMemoryMB, _projectsSinceRecycle);
+                QuitDte();
+            }
+            else if (_recycleAfterProjects > 0 && _projectsSinceRecycle >= _recycleAfterProjects)
+            {
+                conlog.WriteLineInfo("Recycling the {0} after {1} project(s)", _recycleMode == RecycleMode.BACKEND ? "Visual Studio instance" : "volatile solution", _projectsSinceRecycle);
+                if (_recycleMode == RecycleMode.BACKEND)
+                {
+                    QuitDte();
+                }
+                else
+                {
+                    _dte.Solution.Close(_saveVolatileSln);
+                    conlog.WriteLineDebug($"Closed {VolatileSolutionName}");
+                    _pendingUnload.Clear();
+                    _projectsSinceRecycle = 0;
+                    _solutionGeneration++;
+                    CreateVolatileSolution();
+                }
+            }
+        }
+
+        [DllImport("user32.dll")]
+        private static extern uint GetWindowThreadProcessId(IntPtr hWnd, out uint lpdwProcessId);
+
         private int ComputeMaxAttempts(double baseIntervalSec, double approxTotalDurationSec, int minAttempts = 2)
         {
             if (baseIntervalSec <= 0) throw new ArgumentException("baseIntervalSec must be positive");
@@ -237,9 +510,10 @@ namespace VSProjTypeExtractorManaged
                     while (attempt < maxRetries)
                     {
                         attempt++;
+                        Project proj = null;
+                        bool bExtracted = false;
                         try
                         {
-                            Project proj = null;
                             try
                             {
                                 proj = _dte.Solution.AddFromFile(projPath);
@@ -324,7 +598,9 @@ namespace VSProjTypeExtractorManaged
                                 conlog.WriteLineDebug($"ConfigurationManager access for '{projPath}' failed (non-fatal): {exCfg.Message}");
                             }
 
-                            // success: result populated
+                            // success: result populated, the project is no longer needed in the solution
+                            bExtracted = true;
+                            ScheduleUnload(proj, projPath);
                             return;
                         }
                         catch (COMException ex) when ((uint)ex.ErrorCode == 0x8001010A || (uint)ex.ErrorCode == 0x80010001)
@@ -354,6 +630,14 @@ namespace VSProjTypeExtractorManaged
                         {
                             conlog.WriteLineWarn("Unexpected exception loading '{0}': {1} — will retry in {2:0.0}s", projPath, ex.Message, waitSeconds);
                         }
+                        finally
+                        {
+                            // a failed attempt must not leave its project behind, a retry would add another copy of it
+                            if (!bExtracted && proj != null)
+                            {
+                                RemoveFailedProject(proj, projPath);
+                            }
+                        }
 
                         // pump messages and wait before next attempt; cap wait
                         Application.DoEvents();
@@ -381,6 +665,23 @@ namespace VSProjTypeExtractorManaged
             return val;
         }
 
+        /// <summary>
+        /// Returns the cached project data without touching the file system, or null if the result cache is disabled
+        /// or the project is not cached (anymore).
+        /// </summary>
+        public ExtractedProjData TryGetCachedProjectData(string projPath)
+        {
+            try
+            {
+                return _cache != null && _cache.TryGet(projPath, out var cached) ? cached : null;
+            }
+            catch (Exception ex)
+            {
+                conlog.WriteLineDebug("Result cache lookup for '{0}' failed: {1}", projPath, ex.Message);
+                return null;
+            }
+        }
+
         /// <summary>
         /// ExtractProjectData: orchestrates DTE instantiation (if required) and calls STA loader.
         /// Returns the extracted project data.
@@ -394,25 +695,27 @@ namespace VSProjTypeExtractorManaged
                     conlog.InitLogging(_outModeLogging, Path.Combine(_strLogPath, $"{_timeStampPrefix}_{_assemblyName}.log"));
                 }
 
-                // instantiate DTE once
+                // instantiate DTE once, or again after the backend was recycled
                 if (!_bDteInstanciated)
                 {
-                    string progId = $"VisualStudio.DTE.{_VS_MajorVersion}.0";
-                    _dte = Activator.CreateInstance(Type.GetTypeFromProgID(progId)) as DTE;
-
-                    MessageFilter.Register();
-                    _dte.MainWindow.Visible = _showVisualStudio;
-                    _dte.SuppressUI = !_showVisualStudio;
-                    _dte.UserControl = _showVisualStudio;
-
-                    _dte.Solution.Create(Path.GetTempPath(), $"{_timeStampPrefix}_{_assemblyName}.sln");
-                    _bDteInstanciated = true;
-
-                    System.Threading.Thread.Sleep(Convert.ToInt32(1000 * _solutionSleepAfterCreate));
+                    StartDte();
                 }
 
+                // the files the project depends on are stamped before loading it, a change while Visual Studio loads it must not be cached
+                ProjectDataCache.Snapshot cacheSnapshot = _cache?.TakeSnapshot(projPath);
+
                 // perform STA load + extraction
                 ExtractedProjData extracted = LoadProjectAndExtractData(projPath, _projRetriesCount, _projInitialRetryAfterSeconds);
+                _projectsSinceRecycle++;
+                try
+                {
+                    RecycleIfNeeded();
+                }
+                catch (Exception exRecycle)
+                {
+                    conlog.WriteLineWarn("Recycling the volatile solution failed, restarting Visual Studio on the next extraction: {0}", exRecycle.Message);
+                    QuitDte();
+                }
 
                 // always return a non-null ExtractedProjData
                 extracted = extracted ?? new ExtractedProjData { _TypeGuid = "UNKNOWN", _ConfigsPlatforms = null };
@@ -420,6 +723,12 @@ namespace VSProjTypeExtractorManaged
                 // log what we got
                 conlog.WriteLineDebug("Loaded project '{0}' -> TypeGuid={1}, Configs={2}", projPath, extracted._TypeGuid, (extracted._ConfigsPlatforms?.Length ?? 0));
 
+                // failed extractions are retried on the next call instead of being cached
+                if (cacheSnapshot != null && extracted._TypeGuid != "UNKNOWN")
+                {
+                    _cache.Add(cacheSnapshot, extracted);
+                }
+
                 return extracted;
             }
             catch (Exception ex)
@@ -25,10 +25,31 @@ typedef struct
     unsigned int _numCfgPlatforms;
 } ExtractedProjData;
 
+// interned configuration / platform pair, valid until Vspte_CleanUp
+typedef struct
+{
+    const char* _config;
+    const char* _platform;
+    unsigned int _configId;
+    unsigned int _platformId;
+} InternedCfgPlatform;
+
+// extracted project data containing type GUID and interned array of found configuration / platform pairs, valid until Vspte_CleanUp
+typedef struct
+{
+    char _TypeGuid[VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH];
+    const InternedCfgPlatform* _pConfigsPlatforms;
+    unsigned int _numCfgPlatforms;
+} InternedProjData;
+
 // prototypes of exported functions
 typedef bool  (__stdcall *Type_GetProjData)(const char* projPath, ExtractedProjData* pProjData);
+typedef bool  (__stdcall *Type_GetProjTypeGuid)(const char* projPath, char* typeGuid);
+typedef bool  (__stdcall *Type_GetProjDataInterned)(const char* projPath, InternedProjData* pProjData);
+typedef const char* (__stdcall *Type_GetInternedString)(unsigned int id);
 typedef void* (__stdcall *Type_CleanUp)(void);
 typedef void* (__stdcall *Type_DeallocateProjDataCfgArray)(ExtractedProjData* pProjData);
+typedef unsigned long long (__stdcall *Type_GetInvalidationCount)(void);
 
 
 //
@@ -47,13 +68,21 @@ private:
             //
             _hVSProjTypeExtractor = NULL;
             _Vspte_GetProjData = nullptr;
+            _Vspte_GetProjTypeGuid = nullptr;
+            _Vspte_GetProjDataInterned = nullptr;
+            _Vspte_GetInternedString = nullptr;
             _Vspte_CleanUp = nullptr;
             _Vspte_DeallocateProjDataCfgArray = nullptr;
+            _Vspte_GetInvalidationCount = nullptr;
         }
     }
     Type_GetProjData _Vspte_GetProjData = nullptr;
+    Type_GetProjTypeGuid _Vspte_GetProjTypeGuid = nullptr;
+    Type_GetProjDataInterned _Vspte_GetProjDataInterned = nullptr;
+    Type_GetInternedString _Vspte_GetInternedString = nullptr;
     Type_CleanUp _Vspte_CleanUp = nullptr;
     Type_DeallocateProjDataCfgArray _Vspte_DeallocateProjDataCfgArray = nullptr;
+    Type_GetInvalidationCount _Vspte_GetInvalidationCount = nullptr;
     HMODULE _hVSProjTypeExtractor = NULL;
 
 
@@ -80,8 +109,12 @@ public:
                 if (_hVSProjTypeExtractor)
                 {
                     _Vspte_GetProjData = reinterpret_cast<Type_GetProjData>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_GetProjData"));
+                    _Vspte_GetProjTypeGuid = reinterpret_cast<Type_GetProjTypeGuid>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_GetProjTypeGuid"));
+                    _Vspte_GetProjDataInterned = reinterpret_cast<Type_GetProjDataInterned>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_GetProjDataInterned"));
+                    _Vspte_GetInternedString = reinterpret_cast<Type_GetInternedString>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_GetInternedString"));
                     _Vspte_CleanUp = reinterpret_cast<Type_CleanUp>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_CleanUp"));
                     _Vspte_DeallocateProjDataCfgArray = reinterpret_cast<Type_DeallocateProjDataCfgArray>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_DeallocateProjDataCfgArray"));
+                    _Vspte_GetInvalidationCount = reinterpret_cast<Type_GetInvalidationCount>(::GetProcAddress(_hVSProjTypeExtractor, "Vspte_GetInvalidationCount"));
                 }
             }
         }
@@ -119,6 +152,61 @@ public:
         }
     }
 
+    /** @brief  Retrieves basic project data from an existing project, with interned configurations / platforms
+
+        Nothing needs to be deallocated, the configurations / platforms stay valid until @Vspte_CleanUp.
+
+        @param[in] projPath path to visual studio project file
+        @param[in,out] pProjData for receiving the project type GUID and existing configurations
+    */
+    bool Vspte_GetProjDataInterned(const char* projPath, InternedProjData* pProjData)
+    {
+        if (_Vspte_GetProjDataInterned)
+        {
+            return _Vspte_GetProjDataInterned(projPath, pProjData);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    /** @brief  Resolves the ID of an interned configuration or platform name
+
+        @return the interned string valid until @Vspte_CleanUp, or nullptr if the ID is unknown
+    */
+    const char* Vspte_GetInternedString(unsigned int id)
+    {
+        if (_Vspte_GetInternedString)
+        {
+            return _Vspte_GetInternedString(id);
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
+    /** @brief  Retrieves the project type GUID of an existing project without involving Visual Studio
+
+        The project type is resolved by a lookup in a registry of well-known project types, keyed by the Sdk attribute,
+        well-known imported targets or the extension of the project file.
+
+        @param[in] projPath path to visual studio project file
+        @param[out] typeGuid buffer of at least VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH characters for receiving the project type GUID
+    */
+    bool Vspte_GetProjTypeGuid(const char* projPath, char* typeGuid)
+    {
+        if (_Vspte_GetProjTypeGuid)
+        {
+            return _Vspte_GetProjTypeGuid(projPath, typeGuid);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
     /** @brief  Deallocates the configurations / platforms array of an ExtractedProjData instance already used in a call to @Vspte_GetProjData
 
         After a call to @Vspte_GetProjData and copying the data you're interested in from the ExtractedProjData object, you should call this
@@ -132,6 +220,22 @@ public:
         }
     }
 
+    /** @brief  Number of cached results dropped so far because their project file or one of its imports changed
+
+        Always 0 if the result cache is not enabled in VsProjTypeExtractorManaged.xml
+    */
+    unsigned long long Vspte_GetInvalidationCount()
+    {
+        if (_Vspte_GetInvalidationCount)
+        {
+            return _Vspte_GetInvalidationCount();
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
     /** @brief  Optionally closes the volatile solution and quits the Visual Studio instance
 
         After a call to @Vspte_GetProjData, the Visual Studio instance is kept up and running with the volatile solution loaded,
@@ -6,6 +6,12 @@
 #include <vector>
 #include <thread>
 #include <stdexcept>
+#include <filesystem>
+#include <fstream>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <tchar.h>
 
 #include "VSProjLoaderInterface.h"
 
@@ -46,6 +52,8 @@ CTestF_VSProjTypeExtractor::~CTestF_VSProjTypeExtractor()
 
 void CTestF_VSProjTypeExtractor::SetUp()
 {
+    // every test starts with an empty result cache, so that its projects are really extracted by Visual Studio
+    VspteModuleWrapper::Instance()->Vspte_CleanUp();
 }
 
 void CTestF_VSProjTypeExtractor::TearDown()
@@ -56,6 +64,9 @@ void CTestF_VSProjTypeExtractor::TearDown()
 
 void CTestF_VSProjTypeExtractor::SetUpTestCase()
 {
+    // the result cache is read once when the first project is extracted (tc_ResultCacheInvalidation relies on it),
+    // it is emptied before each test by SetUp, so only repeated extractions within a test are answered by it
+    ::SetEnvironmentVariable(TEXT("PROJTYPEXTRACT_RESULTCACHE"), TEXT("true"));
 }
 
 void CTestF_VSProjTypeExtractor::TearDownTestCase()
@@ -107,6 +118,51 @@ void CTestF_VSProjTypeExtractor::SingleExtractProjData(const char* projFileName,
     }
 }
 
+void CTestF_VSProjTypeExtractor::SingleRegistryProjTypeGuid(const char* projFileName, const char* testProjTypeGuid, const char* testProjTypeName)
+{
+    if (VspteModuleWrapper::Instance()->IsLoaded())
+    {
+        std::string strCurrentTestProjPath = strTestDataPath + projFileName;
+
+        char typeGuid[VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH];
+        bool bSuccess = false;
+        EXPECT_NO_THROW(
+            bSuccess = VspteModuleWrapper::Instance()->Vspte_GetProjTypeGuid(
+                strCurrentTestProjPath.c_str(),
+                typeGuid)
+        );
+
+        std::unique_lock<std::mutex> lock(mtxCout);
+        EXPECT_TRUE(bSuccess) << "Calling Vspte_GetProjTypeGuid has failed for the " << testProjTypeName << " project !!!";
+        if (bSuccess)
+        {
+            EXPECT_EQ(strncmp(typeGuid, testProjTypeGuid, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH), 0) << "Registry project type GUID " << typeGuid << " does not match expected " << testProjTypeGuid << " !!!";
+            MYTEST_COUT << "Registry project type GUID for the " << testProjTypeName << " project is " << typeGuid << std::endl;
+        }
+    }
+}
+
+TEST_F(CTestF_VSProjTypeExtractor, tc_RegistryProjTypeGuids)
+{
+    SingleRegistryProjTypeGuid("\\ExternalDummyProject.csproj", "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}", "C#");
+    SingleRegistryProjTypeGuid("\\ExternalDummyProject_2.pyproj", "{888888a0-9f3d-457c-b088-3a5042f75d52}", "Python");
+    SingleRegistryProjTypeGuid("\\ExternalDummyProject_3.wixproj", "{930c7802-8a8c-48f9-8165-68863bccd9dd}", "WiX");
+    // mentions Wix.targets in a comment and as an item, neither of them is imported
+    SingleRegistryProjTypeGuid("\\ExternalDummyProject_4.csproj", "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}", "C# (with WiX mentions)");
+
+    if (VspteModuleWrapper::Instance()->IsLoaded())
+    {
+        std::unique_lock<std::mutex> lock(mtxCout);
+        MYTEST_COUT << "Resolving the project type GUID from an invalid path should FAIL" << std::endl;
+        lock.unlock();
+
+        char typeGuid[VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH];
+        std::string strCurrentTestProjPath = strTestDataPath + "\\NotExistingExternalProject.csproj";
+        EXPECT_FALSE(VspteModuleWrapper::Instance()->Vspte_GetProjTypeGuid(strCurrentTestProjPath.c_str(), typeGuid));
+        EXPECT_FALSE(VspteModuleWrapper::Instance()->Vspte_GetProjTypeGuid(nullptr, typeGuid));
+    }
+}
+
 TEST_F(CTestF_VSProjTypeExtractor, tc_SingleThreadSingleProjectWiX)
 {
     ExtractedProjData projData;
@@ -190,3 +246,187 @@ TEST_F(CTestF_VSProjTypeExtractor, tc_MultipleThreadsMultipleProjects)
 
     MYTEST_COUT << "Parallel extraction of project type GUIDs completed." << std::endl;
 }
+
+TEST_F(CTestF_VSProjTypeExtractor, tc_ResultCacheInvalidation)
+{
+    if (VspteModuleWrapper::Instance()->IsLoaded())
+    {
+        // work on a copy in a folder of its own, as the project file and its neighbours will be modified
+        std::filesystem::path tmpDir = std::filesystem::temp_directory_path() / "VSProjTypeExtractorTest_CacheInvalidation";
+        std::filesystem::remove_all(tmpDir);
+        std::filesystem::create_directories(tmpDir);
+        std::filesystem::path tmpProjPath = tmpDir / "ExternalDummyProject.csproj";
+        std::filesystem::copy_file(strTestDataPath + "\\ExternalDummyProject.csproj", tmpProjPath);
+        const std::string strTmpProjPath = tmpProjPath.string();
+
+        // extracts the project and returns the duration of the call in ms
+        auto extract = [&strTmpProjPath]()
+        {
+            ExtractedProjData projData;
+            auto start = std::chrono::steady_clock::now();
+            EXPECT_TRUE(VspteModuleWrapper::Instance()->Vspte_GetProjData(strTmpProjPath.c_str(), &projData));
+            const double durationMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            EXPECT_EQ(strncmp(projData._TypeGuid, "{FAE04EC0-301F-11D3-BF4B-00C04F79EFBC}", VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH), 0);
+            VspteModuleWrapper::Instance()->Vspte_DeallocateProjDataCfgArray(&projData);
+            return durationMs;
+        };
+        // waits for the change notification (or the polling) to drop a cached project, returns the invalidations counted meanwhile
+        auto waitForInvalidations = [](unsigned long long invalidationsBefore, std::chrono::milliseconds timeout)
+        {
+            unsigned long long invalidationsAfter = invalidationsBefore;
+            for (auto start = std::chrono::steady_clock::now(); std::chrono::steady_clock::now() - start < timeout && invalidationsAfter == invalidationsBefore; )
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                invalidationsAfter = VspteModuleWrapper::Instance()->Vspte_GetInvalidationCount();
+            }
+            return invalidationsAfter - invalidationsBefore;
+        };
+
+        const double extractMs = extract();
+        const double cachedMs = extract();
+        std::unique_lock<std::mutex> lock(mtxCout);
+        MYTEST_COUT << "Extraction took " << extractMs << " ms, the cached result " << cachedMs << " ms" << std::endl;
+        lock.unlock();
+        EXPECT_LT(cachedMs * 10.0, extractMs) << "The second call was not answered by the result cache !!!";
+
+        // a file the project does not depend on must not drop it
+        unsigned long long invalidations = VspteModuleWrapper::Instance()->Vspte_GetInvalidationCount();
+        std::ofstream(tmpDir / "Unrelated.txt") << "not imported by the project" << std::endl;
+        EXPECT_EQ(waitForInvalidations(invalidations, std::chrono::seconds(3)), 0u) << "Writing an unrelated file has dropped the cached project !!!";
+
+        // modifying the project must drop it
+        invalidations = VspteModuleWrapper::Instance()->Vspte_GetInvalidationCount();
+        std::ofstream(tmpProjPath, std::ios::app) << "\r\n";
+        EXPECT_GT(waitForInvalidations(invalidations, std::chrono::seconds(5)), 0u) << "Modifying the cached project has not dropped it !!!";
+
+        // the modified project is extracted and cached again, creating an implicitly imported file must drop it as well
+        extract();
+        invalidations = VspteModuleWrapper::Instance()->Vspte_GetInvalidationCount();
+        std::ofstream(tmpDir / "Directory.Build.props") << "<Project />" << std::endl;
+        EXPECT_GT(waitForInvalidations(invalidations, std::chrono::seconds(5)), 0u) << "Creating Directory.Build.props has not dropped the cached project !!!";
+
+        extract();
+        std::filesystem::remove_all(tmpDir);
+    }
+}
+
+TEST_F(CTestF_VSProjTypeExtractor, tc_InternedConfigsPlatforms)
+{
+    if (VspteModuleWrapper::Instance()->IsLoaded())
+    {
+        std::string strCurrentTestProjPath = strTestDataPath + "\\ExternalDummyProject.csproj";
+
+        ExtractedProjData projData;
+        ASSERT_TRUE(VspteModuleWrapper::Instance()->Vspte_GetProjData(strCurrentTestProjPath.c_str(), &projData));
+
+        InternedProjData internedData;
+        InternedProjData internedDataAgain;
+        ASSERT_TRUE(VspteModuleWrapper::Instance()->Vspte_GetProjDataInterned(strCurrentTestProjPath.c_str(), &internedData));
+        ASSERT_TRUE(VspteModuleWrapper::Instance()->Vspte_GetProjDataInterned(strCurrentTestProjPath.c_str(), &internedDataAgain));
+
+        EXPECT_EQ(strncmp(internedData._TypeGuid, projData._TypeGuid, VSPROJ_TYPEEXTRACT_MAXGUID_LENGTH), 0);
+        ASSERT_EQ(internedData._numCfgPlatforms, projData._numCfgPlatforms);
+        // the same configurations / platforms are stored only once
+        EXPECT_EQ(internedData._pConfigsPlatforms, internedDataAgain._pConfigsPlatforms);
+
+        std::unique_lock<std::mutex> lock(mtxCout);
+        for (unsigned int i = 0; i < internedData._numCfgPlatforms; i++)
+        {
+            const InternedCfgPlatform& cfgPlatform = internedData._pConfigsPlatforms[i];
+            EXPECT_STREQ(cfgPlatform._config, projData._pConfigsPlatforms[i]._config);
+            EXPECT_STREQ(cfgPlatform._platform, projData._pConfigsPlatforms[i]._platform);
+            EXPECT_EQ(cfgPlatform._config, VspteModuleWrapper::Instance()->Vspte_GetInternedString(cfgPlatform._configId));
+            EXPECT_EQ(cfgPlatform._platform, VspteModuleWrapper::Instance()->Vspte_GetInternedString(cfgPlatform._platformId));
+            MYTEST_COUT << "Found interned config / platform pair: '" << cfgPlatform._config << "|" << cfgPlatform._platform
+                << "' (IDs " << cfgPlatform._configId << "|" << cfgPlatform._platformId << ")" << std::endl;
+        }
+        lock.unlock();
+
+        VspteModuleWrapper::Instance()->Vspte_DeallocateProjDataCfgArray(&projData);
+    }
+}
+
+TEST_F(CTestF_VSProjTypeExtractor, tc_SoakFlatLatency)
+{
+    // opt-in, as it runs for a long time: VSPTE_SOAK_PROJECTS is the number of distinct projects to extract, e.g. 1000
+    std::vector<TCHAR> envValue(16);
+    const DWORD dwRes = ::GetEnvironmentVariable(TEXT("VSPTE_SOAK_PROJECTS"), &envValue[0], DWORD(envValue.size()));
+    const int numProjectsEnv = (dwRes > 0 && dwRes < envValue.size()) ? _tstoi(&envValue[0]) : 0;
+    if (numProjectsEnv < 10)
+    {
+        GTEST_SKIP() << "Set VSPTE_SOAK_PROJECTS to at least 10 in order to run the soak test";
+    }
+
+    if (VspteModuleWrapper::Instance()->IsLoaded())
+    {
+        const unsigned int numProjects = unsigned(numProjectsEnv);
+
+        // distinct copies of the C# project, each with its own project GUID, so none of them is already loaded
+        std::string strTemplate;
+        {
+            std::ifstream templateProj(strTestDataPath + "\\ExternalDummyProject.csproj", std::ios::binary);
+            strTemplate.assign(std::istreambuf_iterator<char>(templateProj), std::istreambuf_iterator<char>());
+        }
+        const std::string strTemplateGuid = "02C9DFF6-B45A-451B-A38E-57CDE9DF7734";
+        const size_t posGuid = strTemplate.find(strTemplateGuid);
+        ASSERT_NE(posGuid, std::string::npos);
+
+        std::filesystem::path soakDir = std::filesystem::temp_directory_path() / "VSProjTypeExtractorTest_Soak";
+        std::filesystem::remove_all(soakDir);
+        std::filesystem::create_directories(soakDir);
+
+        std::vector<std::string> projPaths;
+        for (unsigned int i = 0; i < numProjects; i++)
+        {
+            char projGuid[40];
+            snprintf(projGuid, sizeof(projGuid), "02C9DFF6-B45A-451B-A38E-%012X", i);
+            std::string strProj = strTemplate;
+            strProj.replace(posGuid, strTemplateGuid.size(), projGuid);
+
+            projPaths.push_back((soakDir / ("SoakProject_" + std::to_string(i) + ".csproj")).string());
+            std::ofstream(projPaths.back(), std::ios::binary) << strProj;
+        }
+
+        std::unique_lock<std::mutex> lock(mtxCout);
+        MYTEST_COUT << "Extracting " << numProjects << " distinct projects, latency should stay flat..." << std::endl;
+        lock.unlock();
+
+        std::vector<double> latenciesMs;
+        for (const std::string& projPath : projPaths)
+        {
+            ExtractedProjData projData;
+            auto start = std::chrono::steady_clock::now();
+            bool bSuccess = VspteModuleWrapper::Instance()->Vspte_GetProjData(projPath.c_str(), &projData);
+            latenciesMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            EXPECT_TRUE(bSuccess) << "Extraction failed for '" << projPath << "'";
+            VspteModuleWrapper::Instance()->Vspte_DeallocateProjDataCfgArray(&projData);
+        }
+
+        // average per tenth of the run, skipping the very first call which starts Visual Studio
+        const size_t tenth = latenciesMs.size() / 10;
+        std::vector<double> avgPerTenthMs;
+        for (size_t t = 0; t < 10; t++)
+        {
+            const size_t first = (t == 0) ? 1 : t * tenth;
+            const size_t last = (t == 9) ? latenciesMs.size() : (t + 1) * tenth;
+            double sum = 0.0;
+            for (size_t i = first; i < last; i++)
+            {
+                sum += latenciesMs[i];
+            }
+            avgPerTenthMs.push_back(last > first ? sum / double(last - first) : 0.0);
+        }
+
+        lock.lock();
+        for (size_t t = 0; t < avgPerTenthMs.size(); t++)
+        {
+            MYTEST_COUT << "Projects " << (t * 10) << "-" << ((t + 1) * 10) << "%: average latency " << avgPerTenthMs[t] << " ms" << std::endl;
+        }
+        lock.unlock();
+
+        // allow for noise, but not for latency growing with the number of projects already extracted
+        EXPECT_LT(avgPerTenthMs.back(), 2.0 * avgPerTenthMs.front() + 50.0) << "Per-project latency grows over the run !!!";
+
+        std::filesystem::remove_all(soakDir);
+    }
+}
@@ -16,6 +16,7 @@ protected:
     static void TearDownTestCase(void);
 
     static void SingleExtractProjData(const char* projFileName, const char* testProjTypeGuid, const char* testProjTypeName);
+    static void SingleRegistryProjTypeGuid(const char* projFileName, const char* testProjTypeGuid, const char* testProjTypeName);
 
     static std::string strTestDataPath;
     static std::mutex mtxCout;